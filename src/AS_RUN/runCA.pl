@@ -506,6 +506,9 @@ sub setDefaults () {
     $global{"gkpFixInsertSizes"}           = 1;
     $synops{"gkpFixInsertSizes"}           = "Update stddev to 0.10 * mean if it is too large";
 
+    $global{"gkpThreads"}                  = undef;
+    $synops{"gkpThreads"}                  = "Number of threads to use while loading FASTQ reads; default is whatever OpenMP wants";
+
     $global{"gkpAllowInefficientStorage"}  = 0;
     $synops{"gkpAllowInefficientStorage"}  = "Allow mis-ordered reads in gkpStore; storage is inefficient and memory consuming";
 
@@ -528,9 +531,15 @@ sub setDefaults () {
     $global{"doDeDuplication"}             = 1;
     $synops{"doDeDuplication"}             = "Enable the OBT duplication detection and cleaning module for 454 reads, enabled automatically";
 
+    $global{"doDeDuplicationHash"}         = 0;
+    $synops{"doDeDuplicationHash"}         = "Detect duplicates by fingerprinting read prefixes, in bounded memory; finds only duplicates with identical prefixes";
+
     $global{"doChimeraDetection"}          = "normal";
     $synops{"doChimeraDetection"}          = "Enable the OBT chimera detection and cleaning module; 'off', 'normal' or 'aggressive'";
 
+    $global{"obtThreads"}                  = undef;
+    $synops{"obtThreads"}                  = "Number of threads to use in OBT deduplication, final trimming and chimera detection; default is whatever OpenMP wants";
+
     #####  Mer Based Trimming
 
     $global{"mbtBatchSize"}                = 1000000;
@@ -681,6 +690,9 @@ sub setDefaults () {
     $global{"ovlCorrBatchSize"}            = 200000;
     $synops{"ovlCorrBatchSize"}            = "Number of fragments per overlap error correction batch";
 
+    $global{"ovlCorrThreads"}              = 1;
+    $synops{"ovlCorrThreads"}              = "Number of threads to use while recomputing overlap error rates";
+
     $global{"ovlCorrConcurrency"}          = 4;
     $synops{"ovlCorrConcurrency"}          = "If not SGE, number of overlap error correction processes to run at the same time";
 
@@ -785,6 +797,9 @@ sub setDefaults () {
     $global{"extendClearRangesStepSize"}   = undef;
     $synops{"extendClearRangesStepSize"}   = "Batch N scaffolds per ECR run";
 
+    $global{"extendClearRangesConcurrency"}= 4;
+    $synops{"extendClearRangesConcurrency"}= "Number of ECR partitions, and (if not SGE) number of ECR partitions to run at the same time";
+
     $global{"kickOutNonOvlContigs"}        = 0;
     $synops{"kickOutNonOvlContigs"}        = "Allow kicking out a contig placed in a scaffold by mate pairs that has no overlaps to both its left and right neighbor contigs. EXPERT!\n";
 
@@ -814,6 +829,9 @@ sub setDefaults () {
     $global{"cnsConcurrency"}              = 2;
     $synops{"cnsConcurrency"}              = "If not SGE, number of consensus jobs to run at the same time";
 
+    $global{"cnsThreads"}                  = 1;
+    $synops{"cnsThreads"}                  = "Number of threads each contig consensus job uses";
+
     $global{"cnsPhasing"}                  = 0;
     $synops{"cnsPhasing"}                  = "Options for consensus phasing of SNPs\n\t0 - Do not phase SNPs to be consistent.\n\t1 - If two SNPs are joined by reads, phase them to be consistent.";
 
@@ -1972,6 +1990,7 @@ sub preoverlap {
         $cmd .= " -o $wrk/$asm.gkpStore.BUILDING ";
         $cmd .= " -T " if (getGlobal("doOverlapBasedTrimming"));
         $cmd .= " -F " if (getGlobal("gkpFixInsertSizes"));
+        $cmd .= " -threads " . getGlobal("gkpThreads") . " " if (defined(getGlobal("gkpThreads")));
         $cmd .= "$gkpInput ";
         $cmd .= "> $wrk/$asm.gkpStore.err 2>&1";
 
@@ -4181,6 +4200,8 @@ sub overlapTrim {
         $cmd .= "-ovs     $wrk/0-overlaptrim/$asm.dupStore \\\n";
         $cmd .= "-report  $wrk/0-overlaptrim/$asm.deduplicate.log \\\n";
         $cmd .= "-summary $wrk/0-overlaptrim/$asm.deduplicate.summary \\\n";
+        $cmd .= "-hash \\\n"                                      if (getGlobal("doDeDuplicationHash") != 0);
+        $cmd .= "-threads " . getGlobal("obtThreads") . " \\\n"  if ((getGlobal("doDeDuplicationHash") != 0) && (defined(getGlobal("obtThreads"))));
         $cmd .= "> $wrk/0-overlaptrim/$asm.deduplicate.err 2>&1";
 
         stopBefore("deDuplication", $cmd);
@@ -4224,6 +4245,7 @@ sub overlapTrim {
         $cmd .= "  -e $erate \\\n";
         $cmd .= "  -E $elimit \\\n"  if (defined($elimit));
         $cmd .= "  -o $wrk/0-overlaptrim/$asm.finalTrim \\\n";
+        $cmd .= "  -threads " . getGlobal("obtThreads") . " \\\n"  if (defined(getGlobal("obtThreads")));
         $cmd .= "> $wrk/0-overlaptrim/$asm.finalTrim.err 2>&1";
 
         stopBefore("finalTrimming", $cmd);
@@ -4249,6 +4271,7 @@ sub overlapTrim {
             $cmd .= " -E $elimit \\\n";
             $cmd .= " -o $wrk/0-overlaptrim/$asm.chimera \\\n";
             $cmd .= " -mininniepair 0 -minoverhanging 0 \\\n" if (getGlobal("doChimeraDetection") eq "aggressive");
+            $cmd .= " -threads " . getGlobal("obtThreads") . " \\\n" if (defined(getGlobal("obtThreads")));
             $cmd .= " > $wrk/0-overlaptrim/$asm.chimera.err 2>&1";
 
             stopBefore("chimeraDetection", $cmd);
@@ -4445,6 +4468,7 @@ sub overlapCorrection {
 
     if (! -e "$wrk/3-overlapcorrection/ovlcorr.sh") {
         my $batchSize  = getGlobal("ovlCorrBatchSize");
+        my $numThreads = getGlobal("ovlCorrThreads");
         my $jobs       = int($numFrags / $batchSize) + (($numFrags % $batchSize == 0) ? 0 : 1);
         my $taskID       = getGlobal("gridEngineTaskID");
         my $submitTaskID = getGlobal("gridEngineArraySubmitID");
@@ -4477,6 +4501,7 @@ sub overlapCorrection {
         print F "if [ ! -e $wrk/3-overlapcorrection/\$jobid.erate ] ; then\n";
 
         print F "  \$bin/correct-olaps \\\n";
+        print F "    -t $numThreads \\\n";
         print F "    -S $wrk/$asm.ovlStore \\\n";
         print F "    -e $wrk/3-overlapcorrection/\$jobid.erate.WORKING \\\n";
         print F "    $wrk/$asm.gkpStore \\\n";
@@ -5364,13 +5389,17 @@ sub CGW ($$$$$$) {
     }
 
     if (getGlobal("cgwPurgeCheckpoints") != 0) {
-        my $f = findFirstCheckpoint($thisDir);
         my $l = findLastCheckpoint($thisDir);
 
-        while ($f < $l) {
-            #print STDERR "Purging $wrk/$thisDir/$asm.ckp.$f\n";
-            unlink "$wrk/$thisDir/$asm.ckp.$f";
-            $f++;
+        #  Removes the checkpoints before the last, and the blocks only they used.
+
+        $cmd  = "$bin/purgeCheckpoints \\\n";
+        $cmd .= " -c $wrk/$thisDir/$asm \\\n";
+        $cmd .= " -n $l \\\n";
+        $cmd .= "> $wrk/$thisDir/purgeCheckpoints.out 2>&1";
+
+        if (runCommand("$wrk/$thisDir", $cmd)) {
+            caFailure("checkpoint purge failed", "$wrk/$thisDir/purgeCheckpoints.out");
         }
     }
 
@@ -5401,7 +5430,8 @@ sub eCR ($$$) {
         $cmd .= " -t $wrk/$asm.tigStore ";
         $cmd .= " -n $lastckp ";
         $cmd .= " -c $asm ";
-        $cmd .= " -N 4 ";
+        $cmd .= " -N " . getGlobal("extendClearRangesConcurrency") . " ";
+        $cmd .= " -G ";
         $cmd .= " -p $wrk/$thisDir/extendClearRanges.partitionInfo";
         $cmd .= "  > $wrk/$thisDir/extendClearRanges.partitionInfo.err 2>&1";
 
@@ -5425,8 +5455,22 @@ sub eCR ($$$) {
     }
 
     #  Read the partitioning info, create jobs.  No partitions?  No ECR jobs.
+    #
+    #  Each job examines the gaps in its scaffolds against private copies of the stores, and saves
+    #  only a journal of the gaps it closed.  A final merge run replays all the journals to update
+    #  the stores and write the next checkpoint.
 
     my @jobs;
+    my $journals = "";
+
+    my $env;
+
+    $env  = "AS_OVL_ERROR_RATE="  . getGlobal("ovlErrorRate") . "\n";
+    $env .= "AS_CNS_ERROR_RATE="  . getGlobal("cnsErrorRate") . "\n";
+    $env .= "AS_CGW_ERROR_RATE="  . getGlobal("cgwErrorRate") . "\n";
+    $env .= "AS_OVERLAP_MIN_LEN=" . getGlobal("ovlMinLen")    . "\n";
+    $env .= "AS_READ_MIN_LEN="    . getGlobal("frgMinLen")    . "\n";
+    $env .= "export AS_OVL_ERROR_RATE AS_CNS_ERROR_RATE AS_CGW_ERROR_RATE AS_OVERLAP_MIN_LEN AS_READ_MIN_LEN\n";
 
     open(P, "< $wrk/$thisDir/extendClearRanges.partitionInfo") or caFailure("failed to find extendClearRanges partitioning file $wrk/$thisDir/extendClearRanges.partitionInfo", undef);
     while (<P>) {
@@ -5444,12 +5488,7 @@ sub eCR ($$$) {
                 open(F, "> $j.sh");
                 print F "#!" . getGlobal("shell") . "\n\n";
                 print F "\n";
-                print F "AS_OVL_ERROR_RATE=", getGlobal("ovlErrorRate"), "\n";
-                print F "AS_CNS_ERROR_RATE=", getGlobal("cnsErrorRate"), "\n";
-                print F "AS_CGW_ERROR_RATE=", getGlobal("cgwErrorRate"), "\n";
-                print F "AS_OVERLAP_MIN_LEN=", getGlobal("ovlMinLen"),    "\n";
-                print F "AS_READ_MIN_LEN="   , getGlobal("frgMinLen"),    "\n";
-                print F "export AS_OVL_ERROR_RATE AS_CNS_ERROR_RATE AS_CGW_ERROR_RATE AS_OVERLAP_MIN_LEN AS_READ_MIN_LEN\n";
+                print F $env;
                 print F "\n";
                 print F "$bin/extendClearRanges \\\n";
                 print F " -g $wrk/$asm.gkpStore \\\n";
@@ -5458,16 +5497,19 @@ sub eCR ($$$) {
                 print F " -c $asm \\\n";
                 print F " -b $curScaffold -e $endScaffold \\\n";
                 print F " -i $iter \\\n";
-                print F " > $j.err 2>&1\n";
+                print F " -J $j.journal.WORKING \\\n";
+                print F " > $j.err 2>&1 \\\n";
+                print F "&& \\\n";
+                print F "mv $j.journal.WORKING $j.journal\n";
                 close(F);
 
                 system("chmod +x $j.sh");
             }
 
             push @jobs, "$j";
-
-            $lastckp++;
         }
+
+        $journals .= " -R $j.journal";
     }
     close(P);
 
@@ -5477,12 +5519,46 @@ sub eCR ($$$) {
     stopBefore("extendClearRanges", undef);
 
     foreach my $j (@jobs) {
-        if (runCommand("$wrk/$thisDir", "$j.sh")) {
+        schedulerSubmit("$j.sh");
+    }
+
+    schedulerSetNumberOfProcesses(getGlobal("extendClearRangesConcurrency"));
+    schedulerFinish();
+
+    foreach my $j (@jobs) {
+        if (! -e "$j.journal") {
             caFailure("extendClearRanges failed", "$j.err");
         }
         touch("$j.success");
     }
 
+    #  Merge.  Gaps not in a journal -- there shouldn't be any -- are examined as usual.
+
+    if ($journals ne "") {
+        my $j = "$wrk/$thisDir/extendClearRanges-merge";
+
+        open(F, "> $j.sh");
+        print F "#!" . getGlobal("shell") . "\n\n";
+        print F "\n";
+        print F $env;
+        print F "\n";
+        print F "$bin/extendClearRanges \\\n";
+        print F " -g $wrk/$asm.gkpStore \\\n";
+        print F " -t $wrk/$asm.tigStore \\\n";
+        print F " -n $lastckp \\\n";
+        print F " -c $asm \\\n";
+        print F " -i $iter \\\n";
+        print F " $journals \\\n";
+        print F " > $j.err 2>&1\n";
+        close(F);
+
+        system("chmod +x $j.sh");
+
+        if (runCommand("$wrk/$thisDir", "$j.sh")) {
+            caFailure("extendClearRanges merge failed", "$j.err");
+        }
+    }
+
     touch("$wrk/$thisDir/extendClearRanges.success");
 
     return $thisDir;
@@ -5690,6 +5766,8 @@ sub createPostScaffolderConsensusJobs () {
         print F "  -t $wrk/$asm.tigStore $tigVersion \$jobid \\\n";
         print F "  -P ", getGlobal("cnsPhasing"), " \\\n";
         print F "  -U \\\n"  if (getGlobal("cnsReuseUnitigs") != 0);
+        print F "  -threads ", getGlobal("cnsThreads"), " \\\n";
+        print F "  -timing $wrk/8-consensus/${asm}_\$jobid.timing \\\n";
         print F " > $wrk/8-consensus/${asm}_\$jobid.err 2>&1 \\\n";
         print F "&& \\\n";
         print F "touch $wrk/8-consensus/${asm}_\$jobid.success\n";